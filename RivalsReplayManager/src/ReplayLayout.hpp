@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ReplayRecord.hpp"
+
+namespace rrm
+{
+    /// @brief Field layouts of the replay file(`*.roa`) format revisions.
+    /// Each layout is a set of compile-time constants, which `ReplayLayoutCodec` is specialized on,
+    /// so that supporting another revision doesn't add any branch on parsing.
+    /// Widths are in UTF-8 characters. `bool` fields are always a single `0` or `1` digit.
+    ///
+    /// A layout is only used for the versions it was verified against, [`MIN_VERSION`, `MAX_VERSION`].
+    /// To support a new revision, add a layout here and register it on `REPLAY_LAYOUTS` in `ReplayRecord.cpp`.
+
+    /// @brief Layout verified against `2.0.8.0` replays.
+    struct ReplayLayoutV2_0_8
+    {
+        static constexpr const char* NAME = "2.0.8";
+        static constexpr ReplayRecord::Version MIN_VERSION = { {2, 0, 8, 0} };
+        static constexpr ReplayRecord::Version MAX_VERSION = { {2, 0, 8, 0} };
+
+        // Line 1
+        static constexpr int NAME_LENGTH = 32;
+        static constexpr int DESCRIPTION_LENGTH = 140;
+        static constexpr int UNKNOWN_3_DIGITS_LENGTH = 3;
+        static constexpr int GAME_LENGTH_DIGITS = 6;
+        static constexpr int MATCH_TYPE_DIGITS = 1;
+        static constexpr int UNKNOWN_10_DIGITS_LENGTH = 10;
+
+        // Line 2
+        static constexpr int STAGE_DIGITS = 2;
+        static constexpr int STOCKS_DIGITS = 2;
+        static constexpr int TIMER_DIGITS = 2;
+        static constexpr int KNOCKBACK_SCALE_DIGITS = 1;
+        static constexpr int ABYSS_DIGITS = 1;
+        static constexpr int ABYSS_ENDLESS_NUMS_DIGITS = 4;
+        static constexpr int UNKNOWN_9_DIGITS_LENGTH = 9;
+
+        // Player line
+        static constexpr int PLAYER_NAME_LENGTH = 32;
+        static constexpr int PLAYER_TAG_LENGTH = 6;
+        static constexpr int PLAYER_UNKNOWN_1_DIGIT_LENGTH = 1;
+        static constexpr int PLAYER_RIVAL_DIGITS = 2;
+        static constexpr int PLAYER_COLOR_ID_DIGITS = 2;
+        static constexpr int PLAYER_UNKNOWN_7_DIGITS_LENGTH = 7;
+        static constexpr int PLAYER_COLOR_CODE_LENGTH = 50;
+        static constexpr int PLAYER_UNKNOWN_2_DIGITS_LENGTH = 2;
+        static constexpr int PLAYER_BUDDY_DIGITS = 2;
+        static constexpr bool HAS_ABYSS_RUNES = true;
+        static constexpr int PLAYER_ABYSS_RUNES_LENGTH = 15;
+        static constexpr int PLAYER_UNKNOWN_1_DIGIT_2_LENGTH = 1;
+        static constexpr int PLAYER_SCORE_DIGITS = 2;
+        static constexpr int PLAYER_UNKNOWN_8_DIGITS_LENGTH = 8;
+    };
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <bitset>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <utf8help/utf8help.hpp>
+
+#include "ReplayRecord.hpp"
+
+namespace rrm
+{
+    namespace detail
+    {
+        [[nodiscard]] inline bool CheckWorkshopLine(utf8::iterator<std::string::const_iterator> it)
+        {
+            do
+            {
+                if ((char32_t)*it == '$')
+                    return true;
+            } while (((char32_t)*it++) != '\n');
+            return false;
+        }
+
+        [[nodiscard]] inline ReplayRecord::WorkshopItem ReadWorkshopLine(utf8::iterator<std::string::const_iterator>& it)
+        {
+            using namespace utf8help;
+            ++it; // ignore the first '1'
+            const uint64_t steamId = std::stoll(ReadUntil(it, '$'));
+            ++it; // ignore '$'
+            const int majorVer = (int)ReadNum(it, 3);
+            const int minorVer = (int)ReadNum(it, 3);
+            AdvanceToNextLine(it);
+
+            return { steamId, {majorVer, minorVer} };
+        }
+
+        inline void WriteWorkshopLine(const ReplayRecord::WorkshopItem& item, std::string& result)
+        {
+            result += fmt::format("1{}${: >3}{: >3}\r\n", item.steamId, item.versionDigits[0], item.versionDigits[1]);
+        }
+
+        [[nodiscard]] inline bool CheckPlayerLine(utf8::iterator<std::string::const_iterator> it)
+        {
+            const char32_t ch = (char32_t)*it;
+            return ch == 'H' || ('1' <= ch && ch <= '9');
+        }
+    }
+
+    template <typename Layout>
+    struct ReplayLayoutCodec
+    {
+        static_assert(Layout::PLAYER_ABYSS_RUNES_LENGTH <= 15, "abyss runes don't fit in `Player::abyssRunes`");
+
+        /// @brief Parse the fields after the version prefix.
+        /// @param pos points to the first character after the version prefix
+        static void Deserialize(ReplayRecord& record, const std::string& serializedStr, std::string::const_iterator pos)
+        {
+            using namespace utf8help;
+            using namespace detail;
+            using Player = ReplayRecord::Player;
+
+            utf8::iterator it(pos, serializedStr.cbegin(), serializedStr.cend());
+
+            // Line 1 (rest)
+            record.dateTime_.hour = (int)ReadNum(it, 2);
+            record.dateTime_.minute = (int)ReadNum(it, 2);
+            record.dateTime_.second = (int)ReadNum(it, 2);
+            record.dateTime_.day = (int)ReadNum(it, 2);
+            record.dateTime_.month = (int)ReadNum(it, 2);
+            record.dateTime_.year = (int)ReadNum(it, 4);
+
+            record.name_ = RTrimSpace(ReadString(it, Layout::NAME_LENGTH));
+            record.description_ = RTrimSpace(ReadString(it, Layout::DESCRIPTION_LENGTH));
+
+            record.unknown_3_digits_ = ReadString(it, Layout::UNKNOWN_3_DIGITS_LENGTH);
+            record.gameLengthInFrames_ = (int)ReadNum(it, Layout::GAME_LENGTH_DIGITS);
+            record.matchType_ = (ReplayRecord::MatchType)ReadNum(it, Layout::MATCH_TYPE_DIGITS);
+            record.unknown_10_digits_ = ReadString(it, Layout::UNKNOWN_10_DIGITS_LENGTH);
+
+            AdvanceToNextLine(it);
+
+            // Line 2
+            record.aether_ = ReadNum(it, 1) == 1;
+            record.stage_ = (ReplayRecord::Stage)ReadNum(it, Layout::STAGE_DIGITS);
+            record.stocks_ = (int)ReadNum(it, Layout::STOCKS_DIGITS);
+            record.timer_ = (int)ReadNum(it, Layout::TIMER_DIGITS);
+            record.knockbackScale_ = (int)ReadNum(it, Layout::KNOCKBACK_SCALE_DIGITS);
+            record.team_ = ReadNum(it, 1) == 1;
+            record.teamAttack_ = ReadNum(it, 1) == 1;
+            record.showScoresOnTop_ = ReadNum(it, 1) == 1;
+            record.turbo_ = ReadNum(it, 1) == 1;
+            record.devMode_ = ReadNum(it, 1) == 1;
+            record.abyss_ = (ReplayRecord::Abyss)ReadNum(it, Layout::ABYSS_DIGITS);
+            record.abyssEndlessNums_ = (int)ReadNum(it, Layout::ABYSS_ENDLESS_NUMS_DIGITS);
+            record.unknown_9_digits_ = ReadString(it, Layout::UNKNOWN_9_DIGITS_LENGTH);
+
+            AdvanceToNextLine(it);
+
+            // Line
+            if (CheckWorkshopLine(it))
+            {
+                record.workshopStage_ = ReadWorkshopLine(it);
+            }
+
+            // Lines
+            while (CheckPlayerLine(it))
+            {
+                record.players_.push_back(Player());
+                Player& player = record.players_.back();
+
+                // Line
+                std::string humanOrCpuLevel = ReadString(it, 1);
+                if (humanOrCpuLevel == "H")
+                    player.cpuLevel = -1;
+                else
+                    player.cpuLevel = std::stoi(humanOrCpuLevel);
+
+                player.name = RTrimSpace(ReadString(it, Layout::PLAYER_NAME_LENGTH));
+                player.tag = RTrimSpace(ReadString(it, Layout::PLAYER_TAG_LENGTH));
+                player.unknown_1_digit = ReadString(it, Layout::PLAYER_UNKNOWN_1_DIGIT_LENGTH);
+                player.rival = (Player::Rival)ReadNum(it, Layout::PLAYER_RIVAL_DIGITS);
+                player.colorId = (int)ReadNum(it, Layout::PLAYER_COLOR_ID_DIGITS);
+                player.customColorId = (int)ReadNum(it, Layout::PLAYER_COLOR_ID_DIGITS);
+                player.redTeam = ReadNum(it, 1) == 1;
+                player.unknown_7_digits = ReadString(it, Layout::PLAYER_UNKNOWN_7_DIGITS_LENGTH);
+                player.colorCode = RTrimSpace(ReadString(it, Layout::PLAYER_COLOR_CODE_LENGTH));
+                player.unknown_2_digits = ReadString(it, Layout::PLAYER_UNKNOWN_2_DIGITS_LENGTH);
+                player.buddy = (Player::Buddy)ReadNum(it, Layout::PLAYER_BUDDY_DIGITS);
+                player.useWorkshopSkin = ReadNum(it, 1) == 1;
+                if constexpr (Layout::HAS_ABYSS_RUNES)
+                    player.abyssRunes = std::bitset<15>(std::stoull(ReadString(it, Layout::PLAYER_ABYSS_RUNES_LENGTH), nullptr, 2));
+                player.unknown_1_digit_2 = ReadString(it, Layout::PLAYER_UNKNOWN_1_DIGIT_2_LENGTH);
+                player.score = (int)ReadNum(it, Layout::PLAYER_SCORE_DIGITS);
+                player.unknown_8_digits = ReadString(it, Layout::PLAYER_UNKNOWN_8_DIGITS_LENGTH);
+
+                AdvanceToNextLine(it);
+
+                // Line
+                if (player.rival >= Player::Rival::RIVAL_TOTAL_COUNT)
+                {
+                    if (!CheckWorkshopLine(it))
+                        throw std::invalid_argument(fmt::format("Player {} has a workshop rival id of {}, but doesn't have a corresponding steam workshop line.", record.players_.size(), (int)player.rival));
+
+                    player.workshopRival = ReadWorkshopLine(it);
+                }
+                // Line
+                if (player.buddy >= Player::Buddy::BUDDY_TOTAL_COUNT)
+                {
+                    if (!CheckWorkshopLine(it))
+                        throw std::invalid_argument(fmt::format("Player {} has a workshop buddy id of {}, but doesn't have a corresponding steam workshop line.", record.players_.size(), (int)player.buddy));
+
+                    player.workshopBuddy = ReadWorkshopLine(it);
+                }
+                // Line
+                if (player.useWorkshopSkin)
+                {
+                    if (!CheckWorkshopLine(it))
+                        throw std::invalid_argument(fmt::format("Player {} uses a workshop skin, but doesn't have a corresponding steam workshop line.", record.players_.size()));
+
+                    player.workshopSkin = ReadWorkshopLine(it);
+                }
+
+                // Line
+                player.moveInstructions = ReadUntil(it, '\r');
+                AdvanceToNextLine(it);
+            }
+
+            record.unknownFooter_ = std::string(it.base(), serializedStr.end());
+
+            // {Name + Description} * {latin(1 byte) -> other(4 bytes)}
+            record.serializeStrMaxSize_ = (int)serializedStr.size() + (Layout::NAME_LENGTH + Layout::DESCRIPTION_LENGTH) * 3;
+        }
+
+        /// @brief Append the fields after the version prefix to `result`.
+        static void Serialize(const ReplayRecord& record, std::string& result)
+        {
+            using namespace detail;
+
+            // Line 1 (rest)
+            result += fmt::format("{:0>2}{:0>2}{:0>2}{:0>2}{:0>2}{:0>4}", record.dateTime_.hour, record.dateTime_.minute, record.dateTime_.second, record.dateTime_.day, record.dateTime_.month, record.dateTime_.year);
+            result += record.name_;
+            result += std::string(Layout::NAME_LENGTH - utf8::distance(record.name_.begin(), record.name_.end()), ' ');
+            result += record.description_;
+            result += std::string(Layout::DESCRIPTION_LENGTH - utf8::distance(record.description_.begin(), record.description_.end()), ' ');
+            result += record.unknown_3_digits_;
+            result += fmt::format("{:0>{}}", record.gameLengthInFrames_, Layout::GAME_LENGTH_DIGITS);
+            result += fmt::format("{:0>{}}", (int)record.matchType_, Layout::MATCH_TYPE_DIGITS);
+            result += record.unknown_10_digits_;
+            result += "\r\n";
+
+            // Line 2
+            result += std::to_string(record.aether_);
+            result += fmt::format("{:0>{}}", (int)record.stage_, Layout::STAGE_DIGITS);
+            result += fmt::format("{:0>{}}", record.stocks_, Layout::STOCKS_DIGITS);
+            result += fmt::format("{:0>{}}", record.timer_, Layout::TIMER_DIGITS);
+            result += fmt::format("{:0>{}}", record.knockbackScale_, Layout::KNOCKBACK_SCALE_DIGITS);
+            result += std::to_string(record.team_);
+            result += std::to_string(record.teamAttack_);
+            result += std::to_string(record.showScoresOnTop_);
+            result += std::to_string(record.turbo_);
+            result += std::to_string(record.devMode_);
+            result += fmt::format("{:0>{}}", (int)record.abyss_, Layout::ABYSS_DIGITS);
+            result += fmt::format("{:0>{}}", record.abyssEndlessNums_, Layout::ABYSS_ENDLESS_NUMS_DIGITS);
+            result += record.unknown_9_digits_;
+            result += "\r\n";
+
+            // Line
+            if (record.workshopStage_)
+                WriteWorkshopLine(*record.workshopStage_, result);
+
+            // Lines
+            for (const auto& player : record.players_)
+            {
+                // Line
+                result += (player.cpuLevel == -1) ? "H" : std::to_string(player.cpuLevel);
+                result += player.name;
+                result += std::string(Layout::PLAYER_NAME_LENGTH - utf8::distance(player.name.begin(), player.name.end()), ' ');
+                result += player.tag;
+                result += std::string(Layout::PLAYER_TAG_LENGTH - utf8::distance(player.tag.begin(), player.tag.end()), ' ');
+                result += player.unknown_1_digit;
+                result += fmt::format("{:0>{}}", (int)player.rival, Layout::PLAYER_RIVAL_DIGITS);
+                result += fmt::format("{:0>{}}{:0>{}}", player.colorId, Layout::PLAYER_COLOR_ID_DIGITS, player.customColorId, Layout::PLAYER_COLOR_ID_DIGITS);
+                result += std::to_string(player.redTeam);
+                result += player.unknown_7_digits;
+                result += player.colorCode;
+                result += std::string(Layout::PLAYER_COLOR_CODE_LENGTH - utf8::distance(player.colorCode.begin(), player.colorCode.end()), ' ');
+                result += player.unknown_2_digits;
+                result += fmt::format("{:0>{}}", (int)player.buddy, Layout::PLAYER_BUDDY_DIGITS);
+                result += std::to_string(player.useWorkshopSkin);
+                if constexpr (Layout::HAS_ABYSS_RUNES)
+                    result += player.abyssRunes.to_string().substr(15 - Layout::PLAYER_ABYSS_RUNES_LENGTH);
+                result += player.unknown_1_digit_2;
+                result += fmt::format("{: >{}}", player.score, Layout::PLAYER_SCORE_DIGITS);
+                result += player.unknown_8_digits;
+                result += "\r\n";
+
+                // Line
+                if (player.workshopRival)
+                    WriteWorkshopLine(*player.workshopRival, result);
+                // Line
+                if (player.workshopBuddy)
+                    WriteWorkshopLine(*player.workshopBuddy, result);
+                // Line
+                if (player.workshopSkin)
+                    WriteWorkshopLine(*player.workshopSkin, result);
+
+                // Line
+                result += player.moveInstructions;
+                result += "\r\n";
+            }
+
+            result += record.unknownFooter_;
+        }
+    };
+
+    /// @brief Make the registry entry of `Layout`, to be put in a list of layouts sorted by version.
+    template <typename Layout>
+    [[nodiscard]] constexpr ReplayRecord::LayoutEntry MakeLayoutEntry()
+    {
+        static_assert(Layout::MIN_VERSION.ToSortKey() <= Layout::MAX_VERSION.ToSortKey(), "`MIN_VERSION` is greater than `MAX_VERSION`");
+        return { Layout::NAME, Layout::MIN_VERSION, Layout::MAX_VERSION, &ReplayLayoutCodec<Layout>::Deserialize, &ReplayLayoutCodec<Layout>::Serialize };
+    }
+}
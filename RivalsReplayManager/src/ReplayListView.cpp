@@ -0,0 +1,160 @@
+#include "ReplayListView.hpp"
+
+#include <algorithm>
+#include <utf8help/utf8help.hpp>
+
+namespace rrm
+{
+    namespace
+    {
+        /// @brief Case-insensitive collation key, which orders the same as the UTF-8 code unit order of the upper-cased string.
+        [[nodiscard]] std::string MakeCollation(const std::string& str)
+        {
+            if (str.empty())
+                return str;
+            return utf8help::Upper(str);
+        }
+
+        /// @brief Pack the first 8 bytes of the collation key in big-endian, so that most comparisons don't touch the string.
+        [[nodiscard]] uint64_t MakeCollationPrefix(const std::string& collation)
+        {
+            uint64_t prefix = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                prefix <<= 8;
+                if (i < (int)collation.size())
+                    prefix |= (uint8_t)collation[i];
+            }
+            return prefix;
+        }
+
+        /// @brief Player column shows the name of the first player.
+        [[nodiscard]] const std::string& GetPlayerColumnName(const ReplayRecord& record)
+        {
+            static const std::string EMPTY;
+            const auto& players = record.GetPlayers();
+            return players.empty() ? EMPTY : players.front().name;
+        }
+    }
+
+    ReplayListView::ReplayListView(std::span<const ReplayRecord> records)
+        : records_(records), sortedCount_(0), sortColumn_(SortColumn::DATE_TIME), sortOrder_(SortOrder::DESCENDING)
+    {
+        sortKeys_.reserve(records_.size());
+        nameCollations_.reserve(records_.size());
+        playerCollations_.reserve(records_.size());
+
+        for (const auto& record : records_)
+        {
+            nameCollations_.push_back(MakeCollation(record.GetName()));
+            playerCollations_.push_back(MakeCollation(GetPlayerColumnName(record)));
+
+            sortKeys_.push_back({
+                record.GetDateTime().ToSortKey(),
+                (uint64_t)record.GetGameLengthInFrames(),
+                MakeCollationPrefix(nameCollations_.back()),
+                MakeCollationPrefix(playerCollations_.back()),
+            });
+        }
+
+        Sort(sortColumn_, sortOrder_);
+    }
+
+    void ReplayListView::Sort(SortColumn column, SortOrder order)
+    {
+        sortColumn_ = column;
+        sortOrder_ = order;
+        sortedCount_ = 0;
+
+        rows_.resize(records_.size());
+        for (uint32_t i = 0; i < (uint32_t)rows_.size(); ++i)
+        {
+            const SortKeys& keys = sortKeys_[i];
+            uint64_t key = 0;
+            switch (column)
+            {
+            case SortColumn::DATE_TIME:
+                key = keys.dateTime;
+                break;
+            case SortColumn::GAME_LENGTH:
+                key = keys.gameLength;
+                break;
+            case SortColumn::NAME:
+                key = keys.namePrefix;
+                break;
+            case SortColumn::PLAYER:
+                key = keys.playerPrefix;
+                break;
+            }
+            rows_[i] = { (order == SortOrder::DESCENDING) ? ~key : key, i };
+        }
+    }
+
+    std::vector<const ReplayRecord*> ReplayListView::GetWindow(int firstRow, int rowCount)
+    {
+        std::vector<const ReplayRecord*> result;
+
+        firstRow = std::max(firstRow, 0);
+        if (firstRow >= GetRowCount() || rowCount <= 0)
+            return result;
+        const int lastRow = firstRow + std::min(rowCount, GetRowCount() - firstRow);
+
+        EnsureSorted(lastRow);
+
+        result.reserve(lastRow - firstRow);
+        for (int row = firstRow; row < lastRow; ++row)
+            result.push_back(&records_[rows_[row].recordIdx]);
+        return result;
+    }
+
+    int ReplayListView::GetRecordIndex(int row)
+    {
+        if (row < 0 || row >= GetRowCount())
+            return -1;
+
+        EnsureSorted(row + 1);
+        return (int)rows_[row].recordIdx;
+    }
+
+    bool ReplayListView::RowLess(const Row& a, const Row& b) const
+    {
+        if (a.key != b.key)
+            return a.key < b.key;
+
+        // Collation prefixes are equal, fall back to the full collation key
+        if (sortColumn_ == SortColumn::NAME || sortColumn_ == SortColumn::PLAYER)
+        {
+            const auto& collations = (sortColumn_ == SortColumn::NAME) ? nameCollations_ : playerCollations_;
+            const int cmp = collations[a.recordIdx].compare(collations[b.recordIdx]);
+            if (cmp != 0)
+                return (sortOrder_ == SortOrder::DESCENDING) ? cmp > 0 : cmp < 0;
+        }
+
+        // Keep the original order among equal rows
+        return a.recordIdx < b.recordIdx;
+    }
+
+    void ReplayListView::EnsureSorted(int rowCount)
+    {
+        const int totalCount = GetRowCount();
+        rowCount = std::min(rowCount, totalCount);
+        if (rowCount <= sortedCount_)
+            return;
+
+        // Grow the sorted range geometrically, so that scrolling down row by row stays amortized O(n log n) in total.
+        rowCount = std::max(rowCount, std::min(sortedCount_ * 2, totalCount));
+
+        const auto less = [this](const Row& a, const Row& b) { return RowLess(a, b); };
+        const auto first = rows_.begin() + sortedCount_;
+        if (rowCount * 2 >= totalCount)
+        {
+            std::sort(first, rows_.end(), less);
+            sortedCount_ = totalCount;
+        }
+        else
+        {
+            std::partial_sort(first, rows_.begin() + rowCount, rows_.end(), less);
+            sortedCount_ = rowCount;
+        }
+    }
+}
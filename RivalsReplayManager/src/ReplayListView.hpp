@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "ReplayRecord.hpp"
+
+namespace rrm
+{
+    /// @brief Sorted, paginated view over a list of `ReplayRecord`s, meant to back virtualized list widgets.
+    /// Sort keys are precomputed once on construction, and rows are sorted lazily,
+    /// only as far as the requested windows reach.
+    /// Note that the viewed records must outlive this view, and the view must be re-created when they change.
+    class ReplayListView
+    {
+    public:
+        enum class SortColumn
+        {
+            DATE_TIME, GAME_LENGTH, NAME, PLAYER
+        };
+
+        enum class SortOrder
+        {
+            ASCENDING, DESCENDING
+        };
+
+    private:
+        struct Row
+        {
+            uint64_t key; // packed key of the current sort column, bit-inverted when descending
+            uint32_t recordIdx;
+        };
+
+        struct SortKeys
+        {
+            uint64_t dateTime;
+            uint64_t gameLength;
+            uint64_t namePrefix; // first 8 bytes of the name collation key
+            uint64_t playerPrefix; // first 8 bytes of the player collation key
+        };
+
+        std::span<const ReplayRecord> records_;
+        std::vector<SortKeys> sortKeys_;
+        std::vector<std::string> nameCollations_;
+        std::vector<std::string> playerCollations_;
+
+        std::vector<Row> rows_;
+        int sortedCount_; // rows_[0, sortedCount_) are in their final sorted position
+        SortColumn sortColumn_;
+        SortOrder sortOrder_;
+
+    public:
+        /// @brief Build the sort keys of `records`, and sort it by the newest date & time first.
+        /// @param records replay records to view, which must outlive this view
+        ReplayListView(std::span<const ReplayRecord> records);
+
+        /// @brief Change the sort order of the rows.
+        /// This only resets the row order in O(n); actual sorting is deferred until the rows are requested.
+        void Sort(SortColumn column, SortOrder order);
+
+        /// @brief Get the records of the visible window of rows, in the current sort order.
+        /// Only sorts as many rows as needed to reach the end of the window.
+        /// @param firstRow index of the first row in the window
+        /// @param rowCount max number of rows in the window
+        /// @return pointers to the records, which has less than `rowCount` elements if the window exceeds the last row
+        [[nodiscard]] std::vector<const ReplayRecord*> GetWindow(int firstRow, int rowCount);
+
+        /// @brief Get the index of the record shown on `row`, in the span passed on construction.
+        /// @return index of the record, or -1 if `row` is out of range
+        [[nodiscard]] int GetRecordIndex(int row);
+
+        [[nodiscard]] int GetRowCount() const { return (int)rows_.size(); }
+        [[nodiscard]] SortColumn GetSortColumn() const { return sortColumn_; }
+        [[nodiscard]] SortOrder GetSortOrder() const { return sortOrder_; }
+
+    private:
+        [[nodiscard]] bool RowLess(const Row& a, const Row& b) const;
+        void EnsureSorted(int rowCount);
+    };
+}
@@ -6,9 +6,15 @@
 #include <string>
 #include <optional>
 #include <bitset>
+#include <span>
 
 namespace rrm
 {
+    /// @brief (De)serializes `ReplayRecord` fields after the version prefix, specialized on a layout in `ReplayLayout.hpp`.
+    /// Defined in `ReplayLayoutCodec.hpp`.
+    template <typename Layout>
+    struct ReplayLayoutCodec;
+
     /// @brief Stores replay file(`*.roa`) deserialized info.
     /// Note that std::string contained in it are UTF-8 encoded, and doesn't contain any newline char.
     class ReplayRecord
@@ -23,12 +29,36 @@ namespace rrm
         struct Version
         {
             std::array<uint8_t, 4> digits;
+
+            /// @brief Pack the version digits into a single integer, so that comparing two keys gives the release order.
+            [[nodiscard]] constexpr uint32_t ToSortKey() const
+            {
+                return ((uint32_t)digits[0] << 24) | ((uint32_t)digits[1] << 16) | ((uint32_t)digits[2] << 8) | (uint32_t)digits[3];
+            }
+        };
+
+        /// @brief Registry entry of a replay file format revision, made with `MakeLayoutEntry<Layout>()`.
+        struct LayoutEntry
+        {
+            const char* name;
+            Version minVersion;
+            Version maxVersion;
+            void (*deserialize)(ReplayRecord& record, const std::string& serializedStr, std::string::const_iterator pos);
+            void (*serialize)(const ReplayRecord& record, std::string& result);
         };
 
         struct DateTime
         {
             int year, month, day;
             int hour, minute, second;
+
+            /// @brief Pack the date & time into a single integer, so that comparing two keys gives the chronological order.
+            /// @return `YYYYMMDDhhmmss` bit-packed into 40 bits
+            [[nodiscard]] constexpr uint64_t ToSortKey() const
+            {
+                return ((uint64_t)year << 26) | ((uint64_t)month << 22) | ((uint64_t)day << 17)
+                    | ((uint64_t)hour << 12) | ((uint64_t)minute << 6) | (uint64_t)second;
+            }
         };
 
         enum class MatchType
@@ -239,6 +269,9 @@ namespace rrm
         };
 
     private:
+        template <typename Layout>
+        friend struct ReplayLayoutCodec;
+
         // Line 1
         bool starred_;
         Version version_;
@@ -277,14 +310,40 @@ namespace rrm
         // Max size of string returned by this->Serialize()
         int serializeStrMaxSize_;
 
+        // Layout used to parse this, which is also used to serialize
+        LayoutEntry layout_;
+
     public:
         /// @brief Parse ReplayRecord from the `serializedStr`, which is read from the `*.roa` file and uses newline as CRLF(`\r\n`).
+        /// The fields after the version prefix are parsed with the layout registered for that version.
         /// @param serializedStr raw replay file(`*.roa`) string which contains newline as CRLF(`\r\n`)
+        /// @throw std::invalid_argument if no layout is registered for the version of the replay
         ReplayRecord(const std::string& serializedStr);
 
+        /// @brief Parse ReplayRecord from the `serializedStr`, with the layout for its version among `layouts`.
+        /// @param serializedStr raw replay file(`*.roa`) string which contains newline as CRLF(`\r\n`)
+        /// @param layouts registry of layouts, with non-overlapping version ranges
+        /// @throw std::invalid_argument if no layout in `layouts` covers the version of the replay
+        ReplayRecord(const std::string& serializedStr, std::span<const LayoutEntry> layouts);
+
+        /// @brief Find the layout whose version range contains `version`.
+        /// @param layouts registry of layouts, with non-overlapping version ranges
+        /// @return the layout found, or `nullptr` if there's none
+        [[nodiscard]] static const LayoutEntry* FindLayout(std::span<const LayoutEntry> layouts, const Version& version);
+
+        /// @brief Layouts of the replay file format revisions supported by this program.
+        [[nodiscard]] static std::span<const LayoutEntry> GetLayouts();
+
         /// @brief Serialize ReplayRecord to std::string, so that it can be re-written to the `*.roa` file.
         /// Uses CRLF(`\r\n`) as newline.
         /// @return Serialized string ready to be written back to the `*.roa` file
         [[nodiscard]] std::string Serialize();
+
+        [[nodiscard]] const Version& GetVersion() const { return version_; }
+        [[nodiscard]] const LayoutEntry& GetLayout() const { return layout_; }
+        [[nodiscard]] const DateTime& GetDateTime() const { return dateTime_; }
+        [[nodiscard]] const std::string& GetName() const { return name_; }
+        [[nodiscard]] int GetGameLengthInFrames() const { return gameLengthInFrames_; }
+        [[nodiscard]] const std::vector<Player>& GetPlayers() const { return players_; }
     };
 }
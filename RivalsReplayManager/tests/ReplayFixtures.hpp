@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <fmt/core.h>
+
+#include "ReplayLayout.hpp"
+#include "ReplayLayoutCodec.hpp"
+
+namespace rrm::test
+{
+    /// @brief Synthetic revision which differs from `ReplayLayoutV2_0_8`,
+    /// so that the layout-dependent widths and the optional fields are exercised.
+    struct ReplayLayoutSynthetic : ReplayLayoutV2_0_8
+    {
+        static constexpr const char* NAME = "synthetic";
+        static constexpr ReplayRecord::Version MIN_VERSION = { {9, 9, 0, 0} };
+        static constexpr ReplayRecord::Version MAX_VERSION = { {9, 9, 99, 99} };
+
+        static constexpr int GAME_LENGTH_DIGITS = 7;
+        static constexpr int UNKNOWN_10_DIGITS_LENGTH = 12;
+        static constexpr int ABYSS_ENDLESS_NUMS_DIGITS = 5;
+        static constexpr int PLAYER_UNKNOWN_2_DIGITS_LENGTH = 3;
+        static constexpr bool HAS_ABYSS_RUNES = false;
+        static constexpr int PLAYER_SCORE_DIGITS = 3;
+    };
+
+    inline constexpr std::array TEST_LAYOUTS = {
+        MakeLayoutEntry<ReplayLayoutV2_0_8>(),
+        MakeLayoutEntry<ReplayLayoutSynthetic>(),
+    };
+
+    inline constexpr int FIXTURE_GAME_LENGTH = 4321;
+    inline constexpr int FIXTURE_ABYSS_RUNES = 0b000000000000101;
+
+    [[nodiscard]] inline std::string Pad(const std::string& str, int width)
+    {
+        return str + std::string(width - (int)str.size(), ' ');
+    }
+
+    /// @brief Make a replay file string of `version`, laid out with `Layout`.
+    /// @param workshop whether to add steam workshop lines for the stage and the first player's rival
+    template <typename Layout>
+    [[nodiscard]] std::string MakeFixture(const ReplayRecord::Version& version, bool workshop)
+    {
+        std::string s;
+
+        // Line 1
+        s += "1";
+        s += fmt::format("{}{}{:0>2}{:0>2}", version.digits[0], version.digits[1], version.digits[2], version.digits[3]);
+        s += "130019150820" "21";
+        s += Pad("REPLAY 2021-8-15", Layout::NAME_LENGTH);
+        s += Pad("(13:00)", Layout::DESCRIPTION_LENGTH);
+        s += std::string(Layout::UNKNOWN_3_DIGITS_LENGTH, '0');
+        s += fmt::format("{:0>{}}", FIXTURE_GAME_LENGTH, Layout::GAME_LENGTH_DIGITS);
+        s += fmt::format("{:0>{}}", 3, Layout::MATCH_TYPE_DIGITS);
+        s += std::string(Layout::UNKNOWN_10_DIGITS_LENGTH, '0');
+        s += "\r\n";
+
+        // Line 2
+        s += "0";
+        s += fmt::format("{:0>{}}", 2, Layout::STAGE_DIGITS);
+        s += fmt::format("{:0>{}}", 3, Layout::STOCKS_DIGITS);
+        s += fmt::format("{:0>{}}", 8, Layout::TIMER_DIGITS);
+        s += fmt::format("{:0>{}}", 1, Layout::KNOCKBACK_SCALE_DIGITS);
+        s += "01010";
+        s += fmt::format("{:0>{}}", 0, Layout::ABYSS_DIGITS);
+        s += fmt::format("{:0>{}}", 0, Layout::ABYSS_ENDLESS_NUMS_DIGITS);
+        s += std::string(Layout::UNKNOWN_9_DIGITS_LENGTH, '0');
+        s += "\r\n";
+
+        if (workshop)
+            s += "11904437331$  1  6\r\n";
+
+        // Players
+        for (int i = 0; i < 2; ++i)
+        {
+            const bool workshopRival = workshop && i == 0;
+
+            s += (i == 0) ? "H" : "3";
+            s += Pad(fmt::format("Player {}", i + 1), Layout::PLAYER_NAME_LENGTH);
+            s += Pad("TAG", Layout::PLAYER_TAG_LENGTH);
+            s += std::string(Layout::PLAYER_UNKNOWN_1_DIGIT_LENGTH, '0');
+            s += fmt::format("{:0>{}}", workshopRival ? 20 : 3, Layout::PLAYER_RIVAL_DIGITS);
+            s += fmt::format("{:0>{}}{:0>{}}", 1, Layout::PLAYER_COLOR_ID_DIGITS, 1, Layout::PLAYER_COLOR_ID_DIGITS);
+            s += "1";
+            s += std::string(Layout::PLAYER_UNKNOWN_7_DIGITS_LENGTH, '0');
+            s += Pad("3B4986CDF6F6DF00", Layout::PLAYER_COLOR_CODE_LENGTH);
+            s += std::string(Layout::PLAYER_UNKNOWN_2_DIGITS_LENGTH, '0');
+            s += fmt::format("{:0>{}}", 0, Layout::PLAYER_BUDDY_DIGITS);
+            s += "0";
+            if constexpr (Layout::HAS_ABYSS_RUNES)
+                s += fmt::format("{:0>{}b}", FIXTURE_ABYSS_RUNES, Layout::PLAYER_ABYSS_RUNES_LENGTH);
+            s += std::string(Layout::PLAYER_UNKNOWN_1_DIGIT_2_LENGTH, '0');
+            s += fmt::format("{: >{}}", i + 1, Layout::PLAYER_SCORE_DIGITS);
+            s += std::string(Layout::PLAYER_UNKNOWN_8_DIGITS_LENGTH, '0');
+            s += "\r\n";
+
+            if (workshopRival)
+                s += "12345678901$ 12  3\r\n";
+
+            s += (i == 0) ? "1Z127zy180L132Z1136zLE168Z1" : "";
+            s += "\r\n";
+        }
+
+        s += "0\r\n0\r\n";
+        return s;
+    }
+}
@@ -0,0 +1,51 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ReplayFixtures.hpp"
+
+using namespace rrm;
+using namespace rrm::test;
+
+namespace
+{
+    constexpr int RECORD_COUNT = 20000;
+
+    /// @brief Parse and re-serialize `RECORD_COUNT` fixtures of `Layout`, and print the time taken per record.
+    template <typename Layout>
+    bool BenchRoundTrip(const ReplayRecord::Version& version)
+    {
+        std::vector<std::string> fixtures;
+        fixtures.reserve(RECORD_COUNT);
+        for (int i = 0; i < RECORD_COUNT; ++i)
+            fixtures.push_back(MakeFixture<Layout>(version, i % 2 == 0));
+
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<ReplayRecord> records;
+        records.reserve(RECORD_COUNT);
+        const auto parseBegin = Clock::now();
+        for (const auto& fixture : fixtures)
+            records.emplace_back(fixture, TEST_LAYOUTS);
+        const auto parseEnd = Clock::now();
+
+        bool identical = true;
+        for (int i = 0; i < RECORD_COUNT; ++i)
+            identical &= records[i].Serialize() == fixtures[i];
+        const auto serializeEnd = Clock::now();
+
+        const auto perRecordUs = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count() / RECORD_COUNT; };
+        std::cout << Layout::NAME << ": parse " << perRecordUs(parseEnd - parseBegin) << " us/record, serialize "
+            << perRecordUs(serializeEnd - parseEnd) << " us/record" << (identical ? "" : " (round trip MISMATCH)") << '\n';
+        return identical;
+    }
+}
+
+int main()
+{
+    bool identical = true;
+    identical &= BenchRoundTrip<ReplayLayoutV2_0_8>({ {2, 0, 8, 0} });
+    identical &= BenchRoundTrip<ReplayLayoutSynthetic>({ {9, 9, 0, 0} });
+    return identical ? 0 : 1;
+}
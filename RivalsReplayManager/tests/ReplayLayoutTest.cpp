@@ -0,0 +1,134 @@
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "ReplayFixtures.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    void Check(bool condition, const char* expr, int line)
+    {
+        if (!condition)
+        {
+            std::cerr << "ReplayLayoutTest.cpp:" << line << ": CHECK(" << expr << ") failed\n";
+            ++failures;
+        }
+    }
+}
+
+#define CHECK(expr) Check((expr), #expr, __LINE__)
+
+using namespace rrm;
+using namespace rrm::test;
+
+namespace
+{
+    [[nodiscard]] const char* FindLayoutName(const ReplayRecord::Version& version)
+    {
+        const ReplayRecord::LayoutEntry* layout = ReplayRecord::FindLayout(TEST_LAYOUTS, version);
+        return layout ? layout->name : nullptr;
+    }
+
+    [[nodiscard]] bool IsLayout(const char* name, const char* expected)
+    {
+        return name && std::strcmp(name, expected) == 0;
+    }
+
+    template <typename Layout>
+    void TestRoundTrip(const ReplayRecord::Version& version, bool workshop)
+    {
+        const std::string fixture = MakeFixture<Layout>(version, workshop);
+        ReplayRecord record(fixture, TEST_LAYOUTS);
+
+        CHECK(IsLayout(record.GetLayout().name, Layout::NAME));
+        CHECK(record.GetGameLengthInFrames() == FIXTURE_GAME_LENGTH);
+        CHECK(record.GetName() == "REPLAY 2021-8-15");
+        CHECK(record.GetDateTime().year == 2021);
+        CHECK(record.GetPlayers().size() == 2);
+        if (record.GetPlayers().size() == 2)
+        {
+            const ReplayRecord::Player& player = record.GetPlayers()[0];
+            CHECK(player.name == "Player 1");
+            CHECK(player.cpuLevel == -1);
+            CHECK(player.score == 1);
+            CHECK(player.abyssRunes.to_ulong() == (Layout::HAS_ABYSS_RUNES ? FIXTURE_ABYSS_RUNES : 0));
+            CHECK(player.workshopRival.has_value() == workshop);
+            CHECK(record.GetPlayers()[1].cpuLevel == 3);
+        }
+
+        CHECK(record.Serialize() == fixture);
+    }
+
+    void TestRoundTrips()
+    {
+        for (bool workshop : { false, true })
+        {
+            TestRoundTrip<ReplayLayoutV2_0_8>({ {2, 0, 8, 0} }, workshop);
+            TestRoundTrip<ReplayLayoutSynthetic>({ {9, 9, 0, 0} }, workshop);
+            TestRoundTrip<ReplayLayoutSynthetic>({ {9, 9, 99, 99} }, workshop);
+        }
+    }
+
+    /// @brief Pins the `2.0.8.0` layout with literal widths, independent of `ReplayLayoutV2_0_8`.
+    void TestLiteral_2_0_8()
+    {
+        std::string fixture;
+        fixture += "0200800130019150820" "21" + Pad("REPLAY", 32) + Pad("", 140) + "000" "000136" "0" "0000000000" "\r\n";
+        fixture += "0" "02" "01" "12" "0" "0" "0" "0" "0" "0" "0" "0000" "000000000" "\r\n";
+        fixture += "H" + Pad("CHOBO", 32) + Pad("", 6) + "0" "02" "0000" "0" "0000000" + Pad("7A594DDCCB69FFE800FF7F00AA0000D2", 50) + "00" "00" "0" "000000000000001" "0" " 0" "00000000" "\r\n";
+        fixture += "1Z127zy180L132Z1136zLE168Z1\r\n";
+        fixture += "0\r\n0\r\n";
+
+        ReplayRecord record(fixture);
+        CHECK(IsLayout(record.GetLayout().name, ReplayLayoutV2_0_8::NAME));
+        CHECK(record.GetGameLengthInFrames() == 136);
+        CHECK(record.GetPlayers().size() == 1);
+        if (record.GetPlayers().size() == 1)
+        {
+            CHECK(record.GetPlayers()[0].colorCode == "7A594DDCCB69FFE800FF7F00AA0000D2");
+            CHECK(record.GetPlayers()[0].abyssRunes.to_ulong() == 1);
+        }
+        CHECK(record.Serialize() == fixture);
+    }
+
+    void TestDispatchBoundaries()
+    {
+        CHECK(FindLayoutName({ {2, 0, 7, 99} }) == nullptr);
+        CHECK(IsLayout(FindLayoutName({ {2, 0, 8, 0} }), ReplayLayoutV2_0_8::NAME));
+        CHECK(FindLayoutName({ {2, 0, 8, 1} }) == nullptr);
+        CHECK(FindLayoutName({ {9, 8, 99, 99} }) == nullptr);
+        CHECK(IsLayout(FindLayoutName({ {9, 9, 0, 0} }), ReplayLayoutSynthetic::NAME));
+        CHECK(IsLayout(FindLayoutName({ {9, 9, 99, 99} }), ReplayLayoutSynthetic::NAME));
+
+        // The synthetic layout isn't registered for the real parser
+        CHECK(ReplayRecord::FindLayout(ReplayRecord::GetLayouts(), { {9, 9, 0, 0} }) == nullptr);
+        bool thrown = false;
+        try
+        {
+            ReplayRecord record(MakeFixture<ReplayLayoutSynthetic>({ {9, 9, 0, 0} }, false));
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+}
+
+int main()
+{
+    TestRoundTrips();
+    TestLiteral_2_0_8();
+    TestDispatchBoundaries();
+
+    if (failures)
+    {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << "All checks passed\n";
+    return 0;
+}